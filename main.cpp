@@ -1,5 +1,8 @@
+#include <algorithm>
+#include <climits>
 #include <csignal>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <fcntl.h>
 #include <iomanip>
@@ -35,6 +38,8 @@ struct Config {
   int dish_speed_us;
   int cust_min_us;
   int cust_max_us;
+
+  unsigned seed; // Ziarno generatora klientow (0 = losowe)
 };
 
 struct SharedState {
@@ -349,7 +354,7 @@ void process_dishwasher() {
 
 void process_customers() {
   signal(SIGCHLD, SIG_IGN);
-  srand(time(NULL));
+  srand(config.seed ? config.seed : time(NULL));
 
   while (state->running) {
     int delay = config.cust_min_us +
@@ -493,8 +498,423 @@ void process_customers() {
   }
 }
 
-int main(int argc, char *argv[]) {
-  signal(SIGINT, signal_handler);
+// ===== TRYB OPTYMALIZACJI (--optimize) =====
+
+// Koszty zasobow: jednorazowe za sztuke, dostawy za minute pracy
+struct CostModel {
+  double table_2;
+  double table_4;
+  double table_6;
+
+  double veg;
+  double meat;
+  double bread;
+  double disposable;
+
+  double fork;
+  double knife;
+  double spoon;
+
+  double delivery;   // Jeden przyjazd; w koszcie x przyjazdy na minute
+  double smart_mode; // Stala oplata za tryb Smart
+};
+
+// Wynik jednego przebiegu bez wizualizacji (w pamieci wspoldzielonej)
+struct RunResult {
+  int orders;
+  int rejected;
+  int served;
+  bool done;
+};
+
+struct Candidate {
+  Config cfg;
+  double cost;
+  double reject_rate; // % odrzuconych grup
+  double throughput;  // Obsluzeni ludzie / minute
+  int eval_seconds;   // Dlugosc ostatniej oceny
+  bool observed;      // Czy w oknie pomiaru pojawila sie jakakolwiek grupa
+  bool alive;         // Czy przeszedl dotychczasowe rundy
+};
+
+int rand_range(int lo, int hi) { return lo + rand() % (hi - lo + 1); }
+
+double config_cost(const Config &c, const CostModel &m) {
+  double deliveries_per_min = 60000000.0 / c.supplier_speed_us;
+  return c.max_tables_2 * m.table_2 + c.max_tables_4 * m.table_4 +
+         c.max_tables_6 * m.table_6 + c.max_veg * m.veg +
+         c.max_meat * m.meat + c.max_bread * m.bread +
+         c.max_disposable * m.disposable + c.max_forks * m.fork +
+         c.max_knives * m.knife + c.max_spoons * m.spoon +
+         deliveries_per_min * m.delivery +
+         (c.supplier_mode == 2 ? m.smart_mode : 0.0);
+}
+
+// Losowy kandydat w otoczeniu konfiguracji bazowej (klienci bez zmian)
+Config random_candidate(const Config &base) {
+  Config c = base;
+  c.max_tables_2 = rand_range(0, base.max_tables_2 * 2 + 2);
+  c.max_tables_4 = rand_range(0, base.max_tables_4 * 2 + 2);
+  c.max_tables_6 = rand_range(0, base.max_tables_6 * 2 + 2);
+
+  c.max_veg = rand_range(1, base.max_veg * 2 + 10);
+  c.max_meat = rand_range(1, base.max_meat * 2 + 10);
+  c.max_bread = rand_range(1, base.max_bread * 2 + 10);
+  c.max_disposable = rand_range(1, base.max_disposable * 2 + 10);
+
+  c.max_forks = rand_range(0, base.max_forks * 2 + 6);
+  c.max_knives = rand_range(0, base.max_knives * 2 + 6);
+  c.max_spoons = rand_range(0, base.max_spoons * 2 + 6);
+
+  // Od 0.5x do 2x bazowego interwalu dostawcy, bez przepelnienia int.
+  // Min. 50 us, zeby krok paska dostawy (1/50 interwalu) nie byl zerowy
+  int speed_lo = base.supplier_speed_us / 2;
+  if (speed_lo < 50)
+    speed_lo = 50;
+  long long speed_hi = 2LL * base.supplier_speed_us;
+  if (speed_hi > INT_MAX)
+    speed_hi = INT_MAX;
+  if (speed_hi < speed_lo)
+    speed_hi = speed_lo;
+
+  c.supplier_mode = rand_range(1, 2);
+  c.supplier_speed_us = rand_range(speed_lo, (int)speed_hi);
+  return c;
+}
+
+// Rozgrzewka: najdluzszy posilek (4 s) i dwa cykle dostawcy, zeby pomiar
+// nie opieral sie na poczatkowym zapasie magazynu i czystych sztuccach
+int warmup_us(const Config &c) {
+  long long us = 4000000LL + 2LL * c.supplier_speed_us;
+  return us > INT_MAX ? INT_MAX : (int)us;
+}
+
+// Symulacja bez wizualizatora, wywolywana w procesie potomnym.
+// Statystyki liczone sa w stalym oknie `seconds` po rozgrzewce.
+void run_headless(int seconds, RunResult *out) {
+  init_shared_memory();
+
+  pid_t pid_sup = fork();
+  if (pid_sup == 0)
+    process_supplier();
+  pid_t pid_dish = fork();
+  if (pid_dish == 0)
+    process_dishwasher();
+  pid_t pid_gen = fork();
+  if (pid_gen == 0) {
+    process_customers();
+    exit(0);
+  }
+  if (pid_sup < 0 || pid_dish < 0 || pid_gen < 0) {
+    perror("Błąd fork");
+    state->running = false;
+    exit(1);
+  }
+
+  usleep(warmup_us(config));
+
+  pthread_mutex_lock(&state->mutex);
+  int orders0 = state->total_orders_hall + state->total_orders_takeout;
+  int rejected0 =
+      state->rejected_groups_hall + state->rejected_groups_takeout;
+  int served0 = state->served_people_hall + state->served_people_takeout;
+  pthread_mutex_unlock(&state->mutex);
+
+  // Cale sekundy: okno w mikrosekundach nie miesci sie w int od ~36 min
+  unsigned left = seconds;
+  while (left > 0)
+    left = sleep(left);
+
+  pthread_mutex_lock(&state->mutex);
+  out->orders =
+      state->total_orders_hall + state->total_orders_takeout - orders0;
+  out->rejected = state->rejected_groups_hall +
+                  state->rejected_groups_takeout - rejected0;
+  out->served =
+      state->served_people_hall + state->served_people_takeout - served0;
+  pthread_mutex_unlock(&state->mutex);
+
+  state->running = false;
+  waitpid(pid_sup, NULL, 0);
+  waitpid(pid_dish, NULL, 0);
+  waitpid(pid_gen, NULL, 0);
+
+  out->done = true;
+  exit(0);
+}
+
+// Symulacje glownie spia w usleep, wiec limit dotyczy liczby procesow,
+// a nie rdzeni. 0 = wszystkie przebiegi rundy naraz (do limitu)
+const int MAX_PARALLEL_RUNS = 64;
+
+int parallel_limit(int workers, int jobs) {
+  int limit = (workers > 0 && workers < jobs) ? workers : jobs;
+  return limit > MAX_PARALLEL_RUNS ? MAX_PARALLEL_RUNS : limit;
+}
+
+// Ocena zywych kandydatow: kazda replikacja uzywa tego samego ziarna
+// dla wszystkich kandydatow (wspolne liczby losowe)
+void evaluate_round(std::vector<Candidate> &cands, int seconds, int reps,
+                    unsigned seed_base, int workers) {
+  std::vector<int> idx;
+  for (int i = 0; i < (int)cands.size(); i++)
+    if (cands[i].alive)
+      idx.push_back(i);
+
+  int jobs = idx.size() * reps;
+  void *mem = mmap(NULL, jobs * sizeof(RunResult), PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (mem == MAP_FAILED) {
+    perror("Błąd mmap");
+    exit(1);
+  }
+  RunResult *results = (RunResult *)mem;
+
+  int limit = parallel_limit(workers, jobs);
+  int running = 0;
+  for (int j = 0; j < jobs; j++) {
+    if (running >= limit) {
+      wait(NULL);
+      running--;
+    }
+    // Brak procesow: czekamy na zakonczenie ktorejs symulacji i ponawiamy
+    pid_t pid;
+    while ((pid = fork()) < 0) {
+      perror("Błąd fork");
+      if (running == 0)
+        exit(1);
+      wait(NULL);
+      running--;
+    }
+    if (pid == 0) {
+      config = cands[idx[j / reps]].cfg;
+      config.seed = seed_base + j % reps;
+      run_headless(seconds, &results[j]);
+    }
+    running++;
+  }
+  while (running > 0) {
+    wait(NULL);
+    running--;
+  }
+
+  for (int j = 0; j < jobs; j++) {
+    if (!results[j].done) {
+      std::cerr << "Symulacja " << j << " nie zakonczyla sie poprawnie\n";
+      exit(1);
+    }
+  }
+
+  for (int k = 0; k < (int)idx.size(); k++) {
+    int orders = 0, rejected = 0, served = 0;
+    for (int r = 0; r < reps; r++) {
+      RunResult &res = results[k * reps + r];
+      orders += res.orders;
+      rejected += res.rejected;
+      served += res.served;
+    }
+    // Bez zadnej grupy w oknie nie wiadomo nic o odrzuceniach: taki
+    // kandydat nie moze uchodzic za spelniajacy SLO
+    Candidate &c = cands[idx[k]];
+    c.observed = (orders + rejected) > 0;
+    c.reject_rate =
+        c.observed ? 100.0 * rejected / (orders + rejected) : 100.0;
+    c.throughput = served * 60.0 / ((double)reps * seconds);
+    c.eval_seconds = seconds;
+  }
+
+  munmap(mem, jobs * sizeof(RunResult));
+}
+
+// Kolejnosc w rundzie: najpierw spelniajacy SLO (taniej = lepiej),
+// potem reszta (mniej odrzucen = lepiej), na koncu niezmierzeni
+bool candidate_better(const Candidate &a, const Candidate &b, double slo) {
+  if (a.observed != b.observed)
+    return a.observed;
+  bool fa = a.reject_rate <= slo;
+  bool fb = b.reject_rate <= slo;
+  if (fa != fb)
+    return fa;
+  if (fa)
+    return a.cost < b.cost;
+  return a.reject_rate < b.reject_rate;
+}
+
+bool dominates(const Candidate &a, const Candidate &b) {
+  bool no_worse = a.cost <= b.cost && a.reject_rate <= b.reject_rate &&
+                  a.throughput >= b.throughput;
+  bool better = a.cost < b.cost || a.reject_rate < b.reject_rate ||
+                a.throughput > b.throughput;
+  return no_worse && better;
+}
+
+void print_candidate(const Candidate &c, double slo) {
+  const Config &k = c.cfg;
+  std::cout << std::right << std::setw(2) << k.max_tables_2 << "/"
+            << std::setw(2) << k.max_tables_4 << "/" << std::setw(2)
+            << k.max_tables_6 << " | " << std::setw(3) << k.max_veg << "/"
+            << std::setw(3) << k.max_meat << "/" << std::setw(3) << k.max_bread
+            << "/" << std::setw(3) << k.max_disposable << " | " << std::setw(3)
+            << k.max_forks << "/" << std::setw(3) << k.max_knives << "/"
+            << std::setw(3) << k.max_spoons << " | "
+            << (k.supplier_mode == 1 ? "Staly" : "Smart") << " "
+            << std::fixed << std::setprecision(1) << std::setw(4)
+            << k.supplier_speed_us / 1000000.0 << "s | " << std::setw(8)
+            << c.cost << " | " << std::setw(5) << c.reject_rate << "% | "
+            << std::setw(6) << c.throughput << " | " << std::setw(4)
+            << c.eval_seconds << "s | "
+            << (c.reject_rate <= slo ? "TAK" : "nie") << "\n";
+}
+
+void run_optimizer() {
+  CostModel cost;
+  double slo;
+  int n_candidates, seconds, reps, workers;
+
+  // Ctrl+C konczy caly optymalizator, a nie pojedyncze symulacje
+  signal(SIGINT, SIG_DFL);
+
+  std::cout << "\n-- KOSZTY --\n";
+  std::cout << "Stol 2/4/6-osobowy: ";
+  std::cin >> cost.table_2 >> cost.table_4 >> cost.table_6;
+  std::cout << "Miejsce w magazynie (Warzywa Mieso Chleb Jednorazowe): ";
+  std::cin >> cost.veg >> cost.meat >> cost.bread >> cost.disposable;
+  std::cout << "Sztuka (Widelec Noz Lyzka): ";
+  std::cin >> cost.fork >> cost.knife >> cost.spoon;
+  std::cout << "Przyjazd dostawcy (liczony x przyjazdy na minute pracy), "
+               "oplata za tryb Smart: ";
+  std::cin >> cost.delivery >> cost.smart_mode;
+
+  std::cout << "\n-- OPTYMALIZACJA --\n";
+  std::cout << "Max odrzuconych grup (%), kandydaci, czas 1. rundy (s), "
+               "powtorzenia: ";
+  std::cin >> slo >> n_candidates >> seconds >> reps;
+  std::cout << "Max symulacji naraz (0 = cala runda, limit "
+            << MAX_PARALLEL_RUNS << "): ";
+  std::cin >> workers;
+  if (n_candidates < 2)
+    n_candidates = 2;
+  if (seconds < 1)
+    seconds = 1;
+  if (reps < 1)
+    reps = 1;
+  if (workers < 0)
+    workers = 0;
+
+  unsigned seed_base = time(NULL);
+  srand(seed_base);
+
+  // Kandydat 0 to konfiguracja bazowa
+  std::vector<Candidate> cands(n_candidates);
+  for (int i = 0; i < n_candidates; i++) {
+    cands[i].cfg = (i == 0) ? config : random_candidate(config);
+    cands[i].cost = config_cost(cands[i].cfg, cost);
+    cands[i].alive = true;
+  }
+
+  // Successive halving: po kazdej rundzie zostaje lepsza polowa,
+  // a czas oceny sie podwaja
+  int alive = n_candidates;
+  unsigned round_seed = seed_base;
+  for (int round = 1; alive > 0; round++) {
+    std::cout << "\nRunda " << round << ": " << alive << " kandydatow x "
+              << reps << " powt. x " << seconds << "s ("
+              << parallel_limit(workers, alive * reps) << " rownolegle)..."
+              << std::flush;
+    round_seed = seed_base + round * 1000;
+    evaluate_round(cands, seconds, reps, round_seed, workers);
+    std::cout << " gotowe";
+
+    if (alive <= 2)
+      break;
+
+    std::vector<int> idx;
+    for (int i = 0; i < n_candidates; i++)
+      if (cands[i].alive)
+        idx.push_back(i);
+    std::sort(idx.begin(), idx.end(), [&](int a, int b) {
+      return candidate_better(cands[a], cands[b], slo);
+    });
+    alive = (alive + 1) / 2;
+    for (int k = alive; k < (int)idx.size(); k++)
+      cands[idx[k]].alive = false;
+    seconds = seconds > INT_MAX / 2 ? INT_MAX : seconds * 2;
+  }
+
+  // Kandydaci odrzuceni wczesniej byli mierzeni krocej. Ponownie, z
+  // ziarnami ostatniej rundy, mierzymy kazdego, kogo nie dominuje zaden
+  // kandydat zmierzony w pelnej dlugosci (krotkie pomiary nie eliminuja
+  // sie nawzajem)
+  int remeasure = 0;
+  for (int i = 0; i < n_candidates; i++) {
+    bool dominated = false;
+    for (int j = 0; j < n_candidates && !dominated; j++)
+      dominated = cands[j].eval_seconds == seconds && cands[j].observed &&
+                  dominates(cands[j], cands[i]);
+    cands[i].alive =
+        !dominated && cands[i].observed && cands[i].eval_seconds < seconds;
+    if (cands[i].alive)
+      remeasure++;
+  }
+  if (remeasure > 0) {
+    std::cout << "\nPonowny pomiar frontu: " << remeasure << " kandydatow x "
+              << reps << " powt. x " << seconds << "s..." << std::flush;
+    evaluate_round(cands, seconds, reps, round_seed, workers);
+    std::cout << " gotowe";
+  }
+
+  // Front i rekomendacja tylko z pomiarow o koncowej dlugosci,
+  // w ktorych pojawila sie chociaz jedna grupa
+  std::vector<Candidate> final_cands;
+  for (const Candidate &c : cands)
+    if (c.eval_seconds == seconds && c.observed)
+      final_cands.push_back(c);
+
+  std::vector<Candidate> front;
+  for (int i = 0; i < (int)final_cands.size(); i++) {
+    bool dominated = false;
+    for (int j = 0; j < (int)final_cands.size() && !dominated; j++)
+      dominated = (i != j) && dominates(final_cands[j], final_cands[i]);
+    if (!dominated)
+      front.push_back(final_cands[i]);
+  }
+  std::sort(front.begin(), front.end(),
+            [](const Candidate &a, const Candidate &b) {
+              return a.cost < b.cost;
+            });
+
+  std::cout << "\n\n";
+  std::cout << "==========================================================="
+               "===================================\n";
+  std::cout << "          FRONT PARETO (koszt / odrzucenia / przepustowosc)\n";
+  std::cout << "==========================================================="
+               "===================================\n";
+  std::cout << "Stoly    | Magazyn W/M/C/J | Szt. W/N/L  | Dostawa    | "
+               "   Koszt | Odrzuc | Os/min | Ocena | SLO\n";
+  std::cout << "-----------------------------------------------------------"
+               "-----------------------------------\n";
+  for (const Candidate &c : front)
+    print_candidate(c, slo);
+
+  const Candidate *best = nullptr;
+  for (const Candidate &c : front)
+    if (c.reject_rate <= slo && (!best || c.cost < best->cost))
+      best = &c;
+
+  std::cout << "-----------------------------------------------------------"
+               "-----------------------------------\n";
+  if (best) {
+    std::cout << "REKOMENDACJA (najtanszy spelniajacy SLO):\n";
+    print_candidate(*best, slo);
+  } else if (final_cands.empty()) {
+    std::cout << "W oknie pomiaru nie pojawila sie zadna grupa - "
+                 "wydluz czas 1. rundy.\n";
+  } else {
+    std::cout << "Zaden kandydat nie spelnil SLO (" << slo << "%).\n";
+  }
+}
+
+void read_config() {
   double temp_time;
 
   std::cout << "=== KONFIGURACJA RESTAURACJI ===\n\n";
@@ -560,6 +980,18 @@ int main(int argc, char *argv[]) {
     config.max_disposable = 10;
   if (config.supplier_speed_us <= 0)
     config.supplier_speed_us = 4000000;
+  config.seed = 0;
+}
+
+int main(int argc, char *argv[]) {
+  signal(SIGINT, signal_handler);
+
+  read_config();
+
+  if (argc > 1 && strcmp(argv[1], "--optimize") == 0) {
+    run_optimizer();
+    return 0;
+  }
 
   init_shared_memory();
 
@@ -11,6 +11,36 @@ echo "Компиляция проекта..."
 g++ -o simulation main.cpp -lncurses -lpthread
 if [ $? -ne 0 ]; then echo "Ошибка компиляции!"; exit 1; fi
 
+# ==========================================
+# ОПТИМИЗАЦИЯ КОНФИГУРАЦИИ (./run.sh optimize)
+# ==========================================
+# Строки 1-5: базовая конфигурация (как в сценариях ниже)
+# Строка 6: Цена стола 2/4/6-местного
+# Строка 7: Цена места на складе: Овощи  Мясо  Хлеб  Одноразовые
+# Строка 8: Цена прибора: Вилка  Нож  Ложка
+# Строка 9: Цена одной доставки  Доплата_за_Smart
+#           (цена доставки умножается на число доставок в минуту работы
+#            и складывается с разовыми ценами столов/приборов/склада)
+# Строка 10: Макс_отказов(%)  Кандидатов  Время_1_раунда(сек)  Повторов
+# Строка 11: Макс_симуляций_одновременно (0 = весь раунд сразу)
+# Каждый прогон сначала "прогревается" (4 сек + 2 цикла доставки)
+if [ "$1" == "optimize" ]; then
+    $APP --optimize << EOF
+6 5 2
+50 50 50 50
+20 20 20
+2 2 0.5 0.2 0.5
+30
+10 15 20
+0.1 0.2 0.05 0.02
+1 1 1
+5 20
+10 12 2 2
+0
+EOF
+    exit 0
+fi
+
 # ==========================================
 # ФУНКЦИЯ ТЕСТИРОВАНИЯ
 # ==========================================